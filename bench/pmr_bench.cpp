@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scanner.h"
+#include "tables/const_table.h"
+#include "tables/variable_table.h"
+
+using namespace std;
+
+// Поток ввода, буфер которого выделяется из memory_resource запроса
+using PmrIstringstream = basic_istringstream<char, char_traits<char>, std::pmr::polymorphic_allocator<char>>;
+
+// Сканирует один "запрос" (исходный текст src) со свежими таблицами констант и переменных,
+// все выделения памяти которых идут из resource. При withIndex сканер дополнительно строит SymbolIndex.
+// Возвращает число полученных токенов
+size_t scanRequest(const string& src, std::shared_ptr<ConstTable> keywordsTable,
+                   std::shared_ptr<ConstTable> splittersTable, std::shared_ptr<ConstTable> operationsTable,
+                   std::pmr::memory_resource* resource, bool withIndex) {
+   auto constantsTable = std::allocate_shared<VariableTable<ConstMetaData>>(
+       std::pmr::polymorphic_allocator<VariableTable<ConstMetaData>>(resource), resource);
+   auto variablesTable = std::allocate_shared<VariableTable<MetaData>>(
+       std::pmr::polymorphic_allocator<VariableTable<MetaData>>(resource), resource);
+
+   auto scanner =
+       Scanner(keywordsTable, splittersTable, operationsTable, constantsTable, variablesTable, resource);
+
+   // Копия запроса создаётся в resource и передаётся потоку перемещением, без выделений из глобальной кучи
+   PmrIstringstream input(std::pmr::string(src, resource));
+   std::shared_ptr<SymbolIndex> symbolIndex = nullptr;
+   if (withIndex) {
+      symbolIndex =
+          std::allocate_shared<SymbolIndex>(std::pmr::polymorphic_allocator<SymbolIndex>(resource), resource);
+   }
+   auto scanResult = scanner.tokenizeStream(input, symbolIndex);
+   return scanResult.successed() ? scanResult.data->size() : 0;
+}
+
+// Запускает threadsCount потоков, каждый из которых сканирует src iterations раз (с индексом при withIndex).
+// При useArena каждый запрос сканируется в monotonic_buffer_resource, который освобождается целиком
+// после запроса, иначе используется глобальная куча. Возвращает время работы в секундах
+double runBench(const string& src, std::shared_ptr<ConstTable> keywordsTable,
+                std::shared_ptr<ConstTable> splittersTable, std::shared_ptr<ConstTable> operationsTable,
+                size_t threadsCount, size_t iterations, bool useArena, bool withIndex) {
+   vector<thread> threads;
+   vector<size_t> tokensCount(threadsCount, 0);
+
+   auto start = chrono::steady_clock::now();
+   for (size_t t = 0; t < threadsCount; t++) {
+      threads.emplace_back([&, t]() {
+         // Начальный буфер арены, переиспользуется между запросами потока
+         vector<std::byte> arenaBuffer(1 << 20);
+
+         // Локальный счётчик, чтобы соседние элементы tokensCount не делили строку кэша во время замера
+         size_t threadTokens = 0;
+         for (size_t i = 0; i < iterations; i++) {
+            if (useArena) {
+               std::pmr::monotonic_buffer_resource arena(arenaBuffer.data(), arenaBuffer.size());
+               threadTokens += scanRequest(src, keywordsTable, splittersTable, operationsTable, &arena, withIndex);
+            } else {
+               threadTokens += scanRequest(src, keywordsTable, splittersTable, operationsTable,
+                                           std::pmr::get_default_resource(), withIndex);
+            }
+         }
+         tokensCount[t] = threadTokens;
+      });
+   }
+
+   for (auto& thread : threads) {
+      thread.join();
+   }
+   auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   size_t totalTokens = 0;
+   for (auto count : tokensCount) {
+      totalTokens += count;
+   }
+   if (totalTokens == 0) {
+      cout << "Warning: input produced no tokens (scan errors?)\n";
+   }
+
+   return elapsed;
+}
+
+// Использование: lab2_scanner_bench [const_tables_dir] [input_file] [threads] [iterations]
+int main(int argc, char** argv) {
+   setlocale(LC_ALL, "ru-RU.utf-8");
+
+   string tablesDir = argc > 1 ? argv[1] : "../../const_tables";
+   string inputPath = argc > 2 ? argv[2] : "../../test_file.txt";
+   size_t threadsCount = argc > 3 ? stoul(argv[3]) : thread::hardware_concurrency();
+   size_t iterations = argc > 4 ? stoul(argv[4]) : 2000;
+   if (threadsCount == 0) {
+      threadsCount = 1;
+   }
+
+   auto keywordsTable = std::make_shared<ConstTable>();
+   auto splittersTable = std::make_shared<ConstTable>();
+   auto operationsTable = std::make_shared<ConstTable>();
+
+   keywordsTable->readFromFile(tablesDir + "/keywords.txt");
+   splittersTable->readFromFile(tablesDir + "/splitters.txt");
+   operationsTable->readFromFile(tablesDir + "/operations.txt");
+
+   ifstream file(inputPath);
+   if (!file.is_open()) {
+      cout << "Can't open file!\n";
+      return 1;
+   }
+   stringstream ss;
+   ss << file.rdbuf();
+   string src = ss.str();
+
+   cout << "threads: " << threadsCount << ", requests per thread: " << iterations << "\n";
+   for (bool useArena : {false, true}) {
+      // Время сканирования без индекса и с индексом. Запуски чередуются, берётся лучший из repeats,
+      // чтобы уменьшить влияние шума на оценку накладных расходов индекса
+      const int repeats = 30;
+      double bestSeconds[2] = {0, 0};
+      for (int r = 0; r < repeats; r++) {
+         for (bool withIndex : {false, true}) {
+            double seconds = runBench(src, keywordsTable, splittersTable, operationsTable, threadsCount,
+                                      iterations, useArena, withIndex);
+            if (r == 0 || seconds < bestSeconds[withIndex]) {
+               bestSeconds[withIndex] = seconds;
+            }
+         }
+      }
+
+      for (bool withIndex : {false, true}) {
+         double requestsPerSecond = threadsCount * iterations / bestSeconds[withIndex];
+         string label = useArena ? "arena (monotonic_buffer_resource)" : "default heap";
+         label += withIndex ? " + index:" : ":";
+         cout << label << string(label.size() < 44 ? 44 - label.size() : 1, ' ') << bestSeconds[withIndex] * 1000
+              << " ms, " << requestsPerSecond << " requests/s\n";
+      }
+      cout << "symbol index overhead: " << (bestSeconds[1] / bestSeconds[0] - 1) * 100 << "%\n";
+   }
+
+   return 0;
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "scanner.h"
+#include "symbol_index.h"
 #include "tables/const_table.h"
 #include "tables/variable_table.h"
 
@@ -23,21 +24,32 @@ int main(int argc, char** argv) {
 
    auto scanner = Scanner(keywordsTable, splittersTable, operationsTable, constantsTable, variablesTable);
 
-   ifstream file;
-   if (argc == 2) {
-      file = ifstream(argv[1]);
-   }
-   else {
-      file = ifstream("../../test_file.txt");
+   // Использование: lab2_scanner [input_file] [--index]
+   // С флагом --index после потока токенов выводится индекс вхождений констант и переменных
+   string inputPath = "../../test_file.txt";
+   bool printIndex = false;
+   for (int i = 1; i < argc; i++) {
+      if (string(argv[i]) == "--index") {
+         printIndex = true;
+      } else {
+         inputPath = argv[i];
+      }
    }
 
+   ifstream file(inputPath);
+
    if (file.is_open()) {
-      auto scanResult = scanner.tokenizeStream(file);
+      auto symbolIndex = printIndex ? std::make_shared<SymbolIndex>() : nullptr;
+      auto scanResult = scanner.tokenizeStream(file, symbolIndex);
       if (scanResult.successed()) {
          for (auto& token : *scanResult.data) {
             cout << token.toString() << " ";
          }
          cout << endl;
+
+         if (printIndex) {
+            symbolIndex->writeToStream(cout);
+         }
       } else {
          cout << scanResult.error << "\n";
       }
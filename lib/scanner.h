@@ -2,42 +2,16 @@
 
 #include <array>
 #include <fstream>
+#include <memory_resource>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "error_or_t.h"
+#include "symbol_index.h"
 #include "tables/const_table.h"
 #include "tables/variable_table.h"
-
-enum TableNumbers {
-   KEYWORDS,
-   SPLITTERS,
-   OPERATIONS,
-   CONSTANTS,
-   VARIABLES,
-   TABLE_NUMBERS_COUNT,
-};
-
-class Token {
-  public:
-   TableNumbers tableNumber = TableNumbers::TABLE_NUMBERS_COUNT;
-   int indexOfElement = -1;
-
-   bool isEmpty = true;
-
-   Token(TableNumbers tableNumber, int indexOfElement)
-       : tableNumber(tableNumber), indexOfElement(indexOfElement), isEmpty{false} {}
-
-   Token() {}
-
-   std::string toString() const {
-      std::stringstream ss;
-      ss << "(" << tableNumber << ", " << indexOfElement << ")";
-      return ss.str();
-   }
-
-   static Token empty() { return Token(); }
-};
+#include "token.h"
 
 class Scanner {
   private:
@@ -142,6 +116,9 @@ class Scanner {
       return 12;
    }
 
+   // Ресурс памяти, из которого выделяются выходной вектор токенов и временные буферы автомата
+   std::pmr::memory_resource* resource;
+
   public:
    std::shared_ptr<ConstTable> keywordTable;
    std::shared_ptr<ConstTable> splittersTable;
@@ -152,8 +129,10 @@ class Scanner {
 
    Scanner(std::shared_ptr<ConstTable> keywordTable, std::shared_ptr<ConstTable> splittersTable,
            std::shared_ptr<ConstTable> operationsTable, std::shared_ptr<VariableTable<ConstMetaData>> constantsTable,
-           std::shared_ptr<VariableTable<MetaData>> variablesTable)
-       : keywordTable(keywordTable),
+           std::shared_ptr<VariableTable<MetaData>> variablesTable,
+           std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+       : resource(resource),
+         keywordTable(keywordTable),
          splittersTable(splittersTable),
          operationsTable(operationsTable),
          constantsTable(constantsTable),
@@ -243,13 +222,23 @@ class Scanner {
       };
    }
 
-   ErrorOr<std::vector<Token>> tokenizeStream(std::istream& input) {
-      auto outTokens = std::make_shared<std::vector<Token>>();  // Вектор выходных токенов
-      std::string currentLine;   // Текущая считанная строка потока
+   // Функция разбиения потока на токены. Если передан symbolIndex, то во время сканирования в него
+   // записываются номера токенов для каждого элемента таблиц констант и переменных (предыдущее содержимое
+   // индекса очищается; при ошибке сканирования индекс остаётся пустым). Результат выделяется из
+   // memory_resource сканера
+   ErrorOr<std::pmr::vector<Token>> tokenizeStream(std::istream& input,
+                                                   std::shared_ptr<SymbolIndex> symbolIndex = nullptr) {
+      // Вектор выходных токенов
+      auto outTokens = std::allocate_shared<std::pmr::vector<Token>>(std::pmr::polymorphic_allocator<Token>(resource));
+      std::pmr::string currentLine(resource);  // Текущая считанная строка потока
       std::stringstream errors;  // Общий буфер всех ошибок
       bool hasErrors = false;    // Переменная-индикатор ошибок
       size_t lineNumber = 0;     // Номер текущей строки (для вывода ошибок)
 
+      if (symbolIndex) {
+         symbolIndex->clear();
+      }
+
       // Начинаем читать переданный поток построчно
       while (std::getline(input, currentLine)) {
          lineNumber++;
@@ -261,7 +250,7 @@ class Scanner {
          while (charNumber < currentLine.size() - 1) {
             // Инициализируем автомат
             AutomatonStates state = AutomatonStates::INITIAL;  // Текущее состояние машины
-            std::stringstream buf;  // Буфер, который формируется в течение работы автомата
+            std::pmr::string buf(resource);  // Буфер, который формируется в течение работы автомата
             auto token = Token::empty();
             char ch = currentLine.at(charNumber);
             state = automatonMatrix.at(state).at(getCharCategory(ch));
@@ -270,13 +259,13 @@ class Scanner {
             while (state != AutomatonStates::END_SUCCESS && state != AutomatonStates::END_ERROR) {
                switch (state) {
                   case AutomatonStates::INT: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = constantsTable->add(buf.str());
+                        int tokenNum = constantsTable->add(buf);
                         token = Token(TableNumbers::CONSTANTS, tokenNum);
                      }
 
@@ -284,7 +273,7 @@ class Scanner {
                   }
 
                   case AutomatonStates::WORD: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
@@ -292,10 +281,10 @@ class Scanner {
                   }
 
                   case AutomatonStates::KEYWORD: {
-                     int tokenNum = keywordTable->find(buf.str());
+                     int tokenNum = keywordTable->find(buf);
 
                      if (tokenNum == -1) {
-                        tokenNum = variablesTable->add(buf.str());
+                        tokenNum = variablesTable->add(buf);
                         token = Token(TableNumbers::VARIABLES, tokenNum);
                      } else {
                         token = Token(TableNumbers::KEYWORDS, tokenNum);
@@ -306,13 +295,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::OP_EQ: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = operationsTable->find(buf.str());
+                        int tokenNum = operationsTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -323,13 +312,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::OP_EQ_EQ: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = operationsTable->find(buf.str());
+                        int tokenNum = operationsTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -340,7 +329,7 @@ class Scanner {
                   }
 
                   case AutomatonStates::OP_NE: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
@@ -348,13 +337,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::OP_NE_EQ: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = operationsTable->find(buf.str());
+                        int tokenNum = operationsTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -365,13 +354,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::OP_OPERAT: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = operationsTable->find(buf.str());
+                        int tokenNum = operationsTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -382,13 +371,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::MINUS_OPERAT: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = operationsTable->find(buf.str());
+                        int tokenNum = operationsTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -399,13 +388,13 @@ class Scanner {
                   }
 
                   case AutomatonStates::S_SPLIT: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
 
                      if (state == AutomatonStates::END_SUCCESS) {
-                        int tokenNum = splittersTable->find(buf.str());
+                        int tokenNum = splittersTable->find(buf);
                         if (tokenNum == -1) {
                            state = AutomatonStates::END_ERROR;
                         } else {
@@ -416,7 +405,7 @@ class Scanner {
                   }
 
                   case AutomatonStates::WS_WHITESPACE: {
-                     buf << ch;
+                     buf += ch;
                      charNumber++;
                      ch = currentLine.at(charNumber);
                      state = automatonMatrix.at(state).at(getCharCategory(ch));
@@ -428,10 +417,8 @@ class Scanner {
             // Завершаем автомат
             if (state == AutomatonStates::END_ERROR) {
                hasErrors = true;
-               buf.str("");  // Очищаем буфер перед записью туда ошибки
-               buf << "Error: встречен недопустимый символ в позиции: (" << lineNumber << ", " << charNumber + 1
-                   << ").";
-               errors << buf.str() << "\n";
+               errors << "Error: встречен недопустимый символ в позиции: (" << lineNumber << ", " << charNumber + 1
+                      << ").\n";
                // Считываем все символы до пробела или конца строки (скипаем ошибочную структуру - всё равно там уже
                // ошибка)
                while (currentLine.at(charNumber) != '\n' && currentLine.at(charNumber) != ' ') {
@@ -439,6 +426,9 @@ class Scanner {
                }
             } else if (state == AutomatonStates::END_SUCCESS) {
                if (!token.isEmpty) {
+                  if (symbolIndex) {
+                     symbolIndex->add(token, outTokens->size());
+                  }
                   outTokens->push_back(token);
                }
             }
@@ -446,9 +436,13 @@ class Scanner {
       }
 
       if (hasErrors) {
-         return ErrorOr<std::vector<Token>>::withError(errors.str());
+         // Номера токенов в индексе ссылаются на отброшенный вектор, поэтому индекс очищается
+         if (symbolIndex) {
+            symbolIndex->clear();
+         }
+         return ErrorOr<std::pmr::vector<Token>>::withError(errors.str());
       } else {
-         return ErrorOr<std::vector<Token>>::withSuccess(outTokens);
+         return ErrorOr<std::pmr::vector<Token>>::withSuccess(outTokens);
       }
    }
 };
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "token.h"
+
+/// <summary>
+/// Сжатый список вхождений (posting list). Хранит возрастающую последовательность
+/// порядковых номеров токенов в виде разностей с предыдущим номером, каждая разность
+/// кодируется varint-ом (по 7 бит на байт, старший бит - признак продолжения).
+/// Короткие списки хранятся внутри объекта, память выделяется только для длинных
+/// </summary>
+class PostingList {
+  private:
+   // Встроенный буфер для коротких списков
+   static constexpr size_t INLINE_CAPACITY = 16;
+
+   std::array<uint8_t, INLINE_CAPACITY> inlineBytes{};
+   size_t inlineSize = 0;
+   // Буфер, в который список переносится, когда перестаёт помещаться во встроенный
+   std::pmr::vector<uint8_t> bytes;
+   size_t lastOrdinal = 0;
+   size_t count = 0;
+
+   const uint8_t* data() const { return bytes.empty() ? inlineBytes.data() : bytes.data(); }
+   size_t bytesSize() const { return bytes.empty() ? inlineSize : bytes.size(); }
+
+  public:
+   // Тип аллокатора, чтобы pmr-контейнеры передавали свой memory_resource в элементы
+   using allocator_type = std::pmr::polymorphic_allocator<uint8_t>;
+
+   explicit PostingList(const allocator_type& alloc = {}) : bytes(alloc) {}
+   PostingList(const PostingList& other) = default;
+   PostingList(PostingList&& other) = default;
+   PostingList(const PostingList& other, const allocator_type& alloc)
+       : inlineBytes(other.inlineBytes),
+         inlineSize(other.inlineSize),
+         bytes(other.bytes, alloc),
+         lastOrdinal(other.lastOrdinal),
+         count(other.count) {}
+   PostingList(PostingList&& other, const allocator_type& alloc)
+       : inlineBytes(other.inlineBytes),
+         inlineSize(other.inlineSize),
+         bytes(std::move(other.bytes), alloc),
+         lastOrdinal(other.lastOrdinal),
+         count(other.count) {}
+
+   PostingList& operator=(const PostingList& other) = default;
+   PostingList& operator=(PostingList&& other) = default;
+
+   /// <summary>
+   /// Добавляет номер токена в конец списка. Номера должны добавляться строго по возрастанию,
+   /// иначе бросается исключение
+   /// </summary>
+   /// <param name="ordinal"> - порядковый номер токена в выходном векторе</param>
+   void add(size_t ordinal) {
+      if (count != 0 && ordinal <= lastOrdinal) {
+         throw std::invalid_argument("Posting list ordinals must be strictly increasing");
+      }
+
+      // Кодируем разность во временный буфер (varint size_t занимает не более 10 байт)
+      uint8_t encoded[10];
+      size_t encodedSize = 0;
+      size_t delta = count == 0 ? ordinal : ordinal - lastOrdinal;
+      while (delta >= 0x80) {
+         encoded[encodedSize++] = static_cast<uint8_t>(delta | 0x80);
+         delta >>= 7;
+      }
+      encoded[encodedSize++] = static_cast<uint8_t>(delta);
+
+      if (bytes.empty() && inlineSize + encodedSize <= INLINE_CAPACITY) {
+         std::copy(encoded, encoded + encodedSize, inlineBytes.begin() + inlineSize);
+         inlineSize += encodedSize;
+      } else {
+         // Переносим встроенный буфер в выделяемую память при первом переполнении
+         if (bytes.empty()) {
+            bytes.reserve(2 * INLINE_CAPACITY);
+            bytes.assign(inlineBytes.begin(), inlineBytes.begin() + inlineSize);
+         }
+         bytes.insert(bytes.end(), encoded, encoded + encodedSize);
+      }
+
+      lastOrdinal = ordinal;
+      count++;
+   }
+
+   /// <summary>
+   /// Функция распаковки списка
+   /// </summary>
+   /// <returns>номера токенов в порядке возрастания</returns>
+   std::vector<size_t> decode() const {
+      std::vector<size_t> ordinals;
+      ordinals.reserve(count);
+
+      const uint8_t* encoded = data();
+      size_t encodedSize = bytesSize();
+      size_t current = 0;
+      size_t pos = 0;
+      while (pos < encodedSize) {
+         size_t delta = 0;
+         int shift = 0;
+         uint8_t byte;
+         do {
+            byte = encoded[pos++];
+            delta |= static_cast<size_t>(byte & 0x7F) << shift;
+            shift += 7;
+         } while (byte & 0x80);
+
+         current += delta;
+         ordinals.push_back(current);
+      }
+
+      return ordinals;
+   }
+
+   // Последний добавленный номер токена (для пустого списка - 0)
+   size_t last() const { return lastOrdinal; }
+   size_t size() const { return count; }
+   bool empty() const { return count == 0; }
+};
+
+/// <summary>
+/// Обратный индекс: для каждого элемента таблиц констант и переменных хранит
+/// сжатый список номеров токенов, в которых этот элемент встречается.
+/// Строится сканером во время токенизации (см. Scanner::tokenizeStream).
+/// Списки вхождений выделяются из переданного memory_resource
+/// </summary>
+class SymbolIndex {
+  private:
+   // Списки вхождений, индексируются номером элемента в соответствующей таблице
+   std::pmr::vector<PostingList> constants;
+   std::pmr::vector<PostingList> variables;
+
+   std::pmr::vector<PostingList>* listsFor(int tableNumber) {
+      switch (tableNumber) {
+         case TableNumbers::CONSTANTS:
+            return &constants;
+         case TableNumbers::VARIABLES:
+            return &variables;
+         default:
+            return nullptr;
+      }
+   }
+
+   const std::pmr::vector<PostingList>* listsFor(int tableNumber) const {
+      return const_cast<SymbolIndex*>(this)->listsFor(tableNumber);
+   }
+
+  public:
+   explicit SymbolIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+       : constants(resource), variables(resource) {}
+
+   /// <summary>
+   /// Регистрирует вхождение токена. Токены прочих таблиц игнорируются
+   /// </summary>
+   /// <param name="token"> - добавляемый токен</param>
+   /// <param name="ordinal"> - порядковый номер токена в выходном векторе</param>
+   void add(const Token& token, size_t ordinal) { add(token.tableNumber, token.indexOfElement, ordinal); }
+
+   // То же, что и add(token, ordinal), но по номеру таблицы и номеру элемента
+   void add(int tableNumber, int indexOfElement, size_t ordinal) {
+      auto lists = listsFor(tableNumber);
+      if (lists == nullptr || indexOfElement < 0) {
+         return;
+      }
+
+      if (static_cast<size_t>(indexOfElement) >= lists->size()) {
+         // Новые элементы таблиц появляются по одному, поэтому место резервируется с запасом
+         if (static_cast<size_t>(indexOfElement) >= lists->capacity()) {
+            lists->reserve(std::max<size_t>(2 * (indexOfElement + 1), 16));
+         }
+         lists->resize(indexOfElement + 1);
+      }
+      lists->at(indexOfElement).add(ordinal);
+   }
+
+   /// <summary>
+   /// Функция поиска всех вхождений элемента таблицы
+   /// </summary>
+   /// <param name="tableNumber"> - номер таблицы (CONSTANTS или VARIABLES)</param>
+   /// <param name="indexOfElement"> - номер элемента в таблице</param>
+   /// <returns>номера токенов, в которых встречается элемент, либо пустой вектор</returns>
+   std::vector<size_t> occurrences(int tableNumber, int indexOfElement) const {
+      auto lists = listsFor(tableNumber);
+      if (lists == nullptr || indexOfElement < 0 || static_cast<size_t>(indexOfElement) >= lists->size()) {
+         return {};
+      }
+
+      return lists->at(indexOfElement).decode();
+   }
+
+   void clear() {
+      constants.clear();
+      variables.clear();
+   }
+
+   /// <summary>
+   /// Запись индекса в поток в текстовом виде. Каждая строка имеет формат
+   /// "(таблица, элемент): номер номер ...", аналогично Token::toString
+   /// </summary>
+   /// <param name="output"> - выходной поток</param>
+   void writeToStream(std::ostream& output) const {
+      for (int tableNumber : {TableNumbers::CONSTANTS, TableNumbers::VARIABLES}) {
+         auto lists = listsFor(tableNumber);
+         for (size_t i = 0; i < lists->size(); i++) {
+            if (lists->at(i).empty()) {
+               continue;
+            }
+
+            output << "(" << tableNumber << ", " << i << "):";
+            for (auto ordinal : lists->at(i).decode()) {
+               output << " " << ordinal;
+            }
+            output << "\n";
+         }
+      }
+   }
+
+   /// <summary>
+   /// Чтение индекса из потока в формате writeToStream. Текущее содержимое индекса
+   /// заменяется прочитанным. Номера элементов и токенов проверяются по размерам таблиц и
+   /// потока токенов, к которым относится индекс, так что размер выделяемой памяти
+   /// не определяется входными данными
+   /// </summary>
+   /// <param name="input"> - входной поток</param>
+   /// <param name="tokensCount"> - число токенов в соответствующем потоке токенов</param>
+   /// <param name="constantsCount"> - число элементов в таблице констант</param>
+   /// <param name="variablesCount"> - число элементов в таблице переменных</param>
+   void readFromStream(std::istream& input, size_t tokensCount, size_t constantsCount, size_t variablesCount) {
+      clear();
+
+      std::string line;
+      while (std::getline(input, line)) {
+         if (line.empty()) {
+            continue;
+         }
+
+         std::stringstream ss(line);
+         int tableNumber = -1;
+         int indexOfElement = -1;
+         char open = 0, comma = 0, close = 0, colon = 0;
+         // Считываем заголовок вида "(3, 0):"
+         ss >> open >> tableNumber >> comma >> indexOfElement >> close >> colon;
+         if (ss.fail() || open != '(' || comma != ',' || close != ')' || colon != ':' || indexOfElement < 0 ||
+             listsFor(tableNumber) == nullptr) {
+            throw std::runtime_error("Invalid symbol index line: " + line);
+         }
+
+         size_t tableSize = tableNumber == TableNumbers::CONSTANTS ? constantsCount : variablesCount;
+         if (static_cast<size_t>(indexOfElement) >= tableSize) {
+            throw std::runtime_error("Symbol index element out of table range: " + line);
+         }
+
+         auto lists = listsFor(tableNumber);
+         bool hasPrevious =
+             static_cast<size_t>(indexOfElement) < lists->size() && !lists->at(indexOfElement).empty();
+         size_t previous = hasPrevious ? lists->at(indexOfElement).last() : 0;
+
+         // Считываем номера токенов, они должны строго возрастать
+         while (!(ss >> std::ws).eof()) {
+            size_t ordinal;
+            if (!std::isdigit(ss.peek()) || !(ss >> ordinal) || ordinal >= tokensCount ||
+                (hasPrevious && ordinal <= previous)) {
+               throw std::runtime_error("Invalid symbol index line: " + line);
+            }
+
+            add(tableNumber, indexOfElement, ordinal);
+            previous = ordinal;
+            hasPrevious = true;
+         }
+      }
+   }
+};
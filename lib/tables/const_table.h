@@ -2,16 +2,21 @@
 
 #include <fstream>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 /// <summary>
 /// Класс для константных таблиц. Является обёрткой над map\string, int\,
 /// использует string-строки в качестве ключа для поиска и int-значение в
-/// качестве номера этого ключа в линейной таблице
+/// качестве номера этого ключа в линейной таблице.
+/// Узлы и ключи таблицы выделяются из переданного memory_resource
 /// </summary>
 class ConstTable {
   public:
-   std::map<std::string, int> data;
+   std::pmr::map<std::pmr::string, int, std::less<>> data;
+
+   explicit ConstTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : data(resource) {}
 
    /// <summary>
    /// Функция поиска элемента в таблице по ключу (названию элемента)
@@ -19,7 +24,7 @@ class ConstTable {
    /// <param name="elem"> - название элемента</param>
    /// <returns> -1, если элемента в таблице нет, иначе возвращает номер
    /// элемента в таблице</returns>
-   int find(const std::string& elem) {
+   int find(std::string_view elem) const {
       // Пробуем найти элемент в таблице
       auto elemPtr = data.find(elem);
 
@@ -49,8 +54,7 @@ class ConstTable {
          file >> num >> str;
 
          // Добавляем их в хэш-таблицу
-         auto pair = std::make_pair(str, num);
-         data.insert(pair);
+         data.emplace(str, num);
       }
    }
 };
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include <fstream>
 #include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 enum class Type {
    undefined,
@@ -22,7 +24,7 @@ struct ConstMetaData {
 /// Класс для переменных таблиц. Является обёрткой над map\string,pair(int,
 /// MetaData)\, использует string-строки в качестве ключа для поиска, int
 /// значение для определения номера ключа в таблице и MetaData для получения
-/// значения переменной
+/// значения переменной. Узлы и ключи таблицы выделяются из переданного memory_resource
 /// </summary>
 template <typename T>
 class VariableTable {
@@ -31,14 +33,16 @@ class VariableTable {
    int counter = 0;
 
   public:
-   std::map<std::string, std::pair<int, T>> data;
+   std::pmr::map<std::pmr::string, std::pair<int, T>, std::less<>> data;
+
+   explicit VariableTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : data(resource) {}
 
    /// <summary>
    /// Функция поиска элемента по ключу в таблице
    /// </summary>
    /// <param name="elem"> - ключ элемента в таблице</param>
    /// <returns>позиция элемента в таблице (по полю [int])</returns>
-   int find(const std::string& elem) {
+   int find(std::string_view elem) const {
       // Пробуем найти элемент в таблице
       auto elemPtr = data.find(elem);
 
@@ -92,19 +96,18 @@ class VariableTable {
    /// <param name="metadata"> - метаданные элемента</param>
    /// <returns>номер вставленного или уже существующего в таблице
    /// элемента</returns>
-   int add(std::string key, T metadata = T()) {
-      int pos = this->find(key);
+   int add(std::string_view key, T metadata = T()) {
+      auto elemPtr = data.find(key);
 
       // Если элемент с таким ключом уже существует
-      if (pos >= 0) {
+      if (elemPtr != data.end()) {
          // Обновляем метаданные существующего элемента
-         data.at(key).second = metadata;
-         return pos;
+         elemPtr->second.second = metadata;
+         return elemPtr->second.first;
       }
 
       // формируем новую пару для хэш-таблицы и вставляем её в таблицу
-      auto pair = std::make_pair(key, std::make_pair(counter, metadata));
-      data.insert(pair);
+      data.emplace(key, std::make_pair(counter, metadata));
       return counter++;
    }
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+
+enum TableNumbers {
+   KEYWORDS,
+   SPLITTERS,
+   OPERATIONS,
+   CONSTANTS,
+   VARIABLES,
+   TABLE_NUMBERS_COUNT,
+};
+
+class Token {
+  public:
+   TableNumbers tableNumber = TableNumbers::TABLE_NUMBERS_COUNT;
+   int indexOfElement = -1;
+
+   bool isEmpty = true;
+
+   Token(TableNumbers tableNumber, int indexOfElement)
+       : tableNumber(tableNumber), indexOfElement(indexOfElement), isEmpty{false} {}
+
+   Token() {}
+
+   std::string toString() const {
+      std::stringstream ss;
+      ss << "(" << tableNumber << ", " << indexOfElement << ")";
+      return ss.str();
+   }
+
+   static Token empty() { return Token(); }
+};